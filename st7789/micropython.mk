@@ -4,3 +4,5 @@ SRC_USERMOD += $(addprefix $(ST7789_MOD_DIR)/, \
 )
 CFLAGS_USERMOD += -I$(ST7789_MOD_DIR) -DMODULE_ST7789_ENABLED=1
 # CFLAGS_USERMOD += -DEXPOSE_EXTRA_METHODS=1
+# CFLAGS_USERMOD += -DST7789_PARALLEL_BUS=1
+# CFLAGS_USERMOD += -DST7789_MOCK_BUS=1
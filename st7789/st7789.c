@@ -24,52 +24,273 @@
 
 #define __ST7789_VERSION__  "0.1.5"
 
+#include <string.h>
+
 #include "py/obj.h"
 #include "py/runtime.h"
 #include "py/builtin.h"
 #include "py/mphal.h"
-#include "extmod/machine_spi.h"
+#include "py/stream.h"
 
 #include "st7789.h"
 
+// the recording mock is meant for hosts without GPIO such as the unix port,
+// building it in replaces the pin-driven transports
+#ifdef ST7789_MOCK_BUS
+#ifdef ST7789_PARALLEL_BUS
+#error "ST7789_MOCK_BUS can't be combined with ST7789_PARALLEL_BUS"
+#endif
+#define ST7789_USE_PINS (0)
+#else
+#define ST7789_USE_PINS (1)
+#include "extmod/machine_spi.h"
+#endif
+
 // allow compiling against MP <=1.12
 #ifndef MP_ERROR_TEXT
 #define MP_ERROR_TEXT(a) a
 #endif
+#ifndef mp_obj_is_type
+#define mp_obj_is_type(o, t) MP_OBJ_IS_TYPE(o, t)
+#endif
+#ifndef mp_obj_is_int
+#define mp_obj_is_int(o) MP_OBJ_IS_INT(o)
+#endif
 
 #define _swap_int16_t(a, b) { int16_t t = a; a = b; b = t; }
 #define ABS(N) (((N)<0)?(-(N)):(N))
 #define mp_hal_delay_ms(delay)  (mp_hal_delay_us(delay * 1000))
 
+#if ST7789_USE_PINS
 #define CS_LOW()     { if(self->cs) {mp_hal_pin_write(self->cs, 0);} }
 #define CS_HIGH()    { if(self->cs) {mp_hal_pin_write(self->cs, 1);} }
-#define DC_LOW()     mp_hal_pin_write(self->dc, 0)
-#define DC_HIGH()    mp_hal_pin_write(self->dc, 1)
+// the D/C level is cached within a transaction, so that back-to-back data
+// writes do not touch the pin
+#define DC_LOW()     { if(self->dc_level != 0) {mp_hal_pin_write(self->dc, 0); self->dc_level = 0;} }
+#define DC_HIGH()    { if(self->dc_level != 1) {mp_hal_pin_write(self->dc, 1); self->dc_level = 1;} }
 #define RESET_LOW()  mp_hal_pin_write(self->reset, 0)
 #define RESET_HIGH() mp_hal_pin_write(self->reset, 1)
 #define DISP_HIGH()  mp_hal_pin_write(self->backlight, 1)
 #define DISP_LOW()   mp_hal_pin_write(self->backlight, 0)
+#else
+#define CS_LOW()     (void)self
+#define CS_HIGH()    (void)self
+#define RESET_LOW()  (void)self
+#define RESET_HIGH() (void)self
+#define DISP_HIGH()  (void)self
+#define DISP_LOW()   (void)self
+#endif
 
+#define BUS_BEGIN()  self->bus->begin(self)
+#define BUS_END()    self->bus->end(self)
 
-STATIC void write_spi(mp_obj_base_t *spi_obj, const uint8_t *buf, int len) {
-    mp_machine_spi_p_t *spi_p = (mp_machine_spi_p_t*)spi_obj->type->protocol;
-    spi_p->transfer(spi_obj, len, buf, NULL);
-}
+
+typedef struct _st7789_ST7789_obj_t st7789_ST7789_obj_t;
+
+// bus transport, selected per display in the constructor
+typedef struct _st7789_bus_t {
+    // select the display for a series of commands and data writes
+    void (*begin)(st7789_ST7789_obj_t *self);
+    void (*end)(st7789_ST7789_obj_t *self);
+    void (*command)(st7789_ST7789_obj_t *self, uint8_t cmd);
+    void (*data)(st7789_ST7789_obj_t *self, const uint8_t *buf, int len);
+    // send `length` pixels of the same color
+    void (*fill)(st7789_ST7789_obj_t *self, uint16_t color, int length);
+} st7789_bus_t;
 
 // this is the actual C-structure for our new object
-typedef struct _st7789_ST7789_obj_t {
+struct _st7789_ST7789_obj_t {
     mp_obj_base_t base;
 
+    const st7789_bus_t *bus;
     mp_obj_base_t *spi_obj;
+#ifdef ST7789_PARALLEL_BUS
+    mp_hal_pin_obj_t data_pins[8];
+    mp_hal_pin_obj_t wr;
+    int16_t data_level;
+#endif
+#ifdef ST7789_MOCK_BUS
+    mp_obj_t mock_log;
+#endif
     uint8_t width;
     uint8_t height;
     uint8_t xstart;
     uint8_t ystart;
+#if ST7789_USE_PINS
+    int8_t dc_level;
     mp_hal_pin_obj_t reset;
     mp_hal_pin_obj_t dc;
     mp_hal_pin_obj_t cs;
     mp_hal_pin_obj_t backlight;
-} st7789_ST7789_obj_t;
+#endif
+};
+
+
+/* machine.SPI transport */
+
+#if ST7789_USE_PINS
+
+STATIC void write_spi(mp_obj_base_t *spi_obj, const uint8_t *buf, int len) {
+    mp_machine_spi_p_t *spi_p = (mp_machine_spi_p_t*)spi_obj->type->protocol;
+    spi_p->transfer(spi_obj, len, buf, NULL);
+}
+
+STATIC void spi_begin(st7789_ST7789_obj_t *self) {
+    // D/C may be shared with another display or toggled elsewhere,
+    // only trust the cached level within a transaction
+    self->dc_level = -1;
+    CS_LOW();
+}
+
+STATIC void spi_end(st7789_ST7789_obj_t *self) {
+    CS_HIGH();
+}
+
+STATIC void spi_command(st7789_ST7789_obj_t *self, uint8_t cmd) {
+    DC_LOW();
+    write_spi(self->spi_obj, &cmd, 1);
+}
+
+STATIC void spi_data(st7789_ST7789_obj_t *self, const uint8_t *buf, int len) {
+    DC_HIGH();
+    write_spi(self->spi_obj, buf, len);
+}
+
+STATIC void spi_fill(st7789_ST7789_obj_t *self, uint16_t color, int length) {
+    uint8_t hi = color >> 8, lo = color;
+    const int buffer_pixel_size = 128;
+    int chunks = length / buffer_pixel_size;
+    int rest = length % buffer_pixel_size;
+
+    uint8_t buffer[buffer_pixel_size * 2]; // 128 pixels
+    // fill buffer with color data
+    for (int i = 0; i < length && i < buffer_pixel_size; i++) {
+        buffer[i*2] = hi;
+        buffer[i*2 + 1] = lo;
+    }
+
+    DC_HIGH();
+    if (chunks) {
+        for (int j = 0; j < chunks; j ++) {
+            write_spi(self->spi_obj, buffer, buffer_pixel_size*2);
+        }
+    }
+    if (rest) {
+        write_spi(self->spi_obj, buffer, rest*2);
+    }
+}
+
+STATIC const st7789_bus_t spi_bus = {
+    .begin = spi_begin,
+    .end = spi_end,
+    .command = spi_command,
+    .data = spi_data,
+    .fill = spi_fill,
+};
+
+#endif
+
+
+/* 8-bit 8080 parallel transport */
+
+#ifdef ST7789_PARALLEL_BUS
+
+// A port may define ST7789_PARALLEL_WRITE8(self, value) to put a byte on
+// D0..D7 with a single GPIO group write. The fallback below writes the pins
+// one by one and skips the ones that keep their level.
+#ifndef ST7789_PARALLEL_WRITE8
+STATIC void parallel_write8(st7789_ST7789_obj_t *self, uint8_t value) {
+    uint8_t changed = self->data_level < 0 ? 0xFF : value ^ self->data_level;
+    for (int i = 0; i < 8; i++) {
+        if (changed & (1 << i)) {
+            mp_hal_pin_write(self->data_pins[i], (value >> i) & 1);
+        }
+    }
+    self->data_level = value;
+}
+#define ST7789_PARALLEL_WRITE8(self, value) parallel_write8(self, value)
+#endif
+
+// data is latched on the rising edge of WR
+#define WR_STROBE() { mp_hal_pin_write(self->wr, 0); mp_hal_pin_write(self->wr, 1); }
+
+STATIC void parallel_command(st7789_ST7789_obj_t *self, uint8_t cmd) {
+    DC_LOW();
+    ST7789_PARALLEL_WRITE8(self, cmd);
+    WR_STROBE();
+}
+
+STATIC void parallel_data(st7789_ST7789_obj_t *self, const uint8_t *buf, int len) {
+    DC_HIGH();
+    for (int i = 0; i < len; i++) {
+        ST7789_PARALLEL_WRITE8(self, buf[i]);
+        WR_STROBE();
+    }
+}
+
+STATIC void parallel_fill(st7789_ST7789_obj_t *self, uint16_t color, int length) {
+    uint8_t hi = color >> 8, lo = color;
+    DC_HIGH();
+    if (hi == lo) {
+        // the bus already holds the right byte, only strobe it
+        ST7789_PARALLEL_WRITE8(self, hi);
+        for (int i = 0; i < length * 2; i++) {
+            WR_STROBE();
+        }
+        return;
+    }
+    for (int i = 0; i < length; i++) {
+        ST7789_PARALLEL_WRITE8(self, hi);
+        WR_STROBE();
+        ST7789_PARALLEL_WRITE8(self, lo);
+        WR_STROBE();
+    }
+}
+
+STATIC const st7789_bus_t parallel_bus = {
+    .begin = spi_begin,
+    .end = spi_end,
+    .command = parallel_command,
+    .data = parallel_data,
+    .fill = parallel_fill,
+};
+
+#endif
+
+
+/* recording transport for tests, appends every bus operation to a list:
+ * command -> int, data -> bytes, fill -> (color, length) */
+
+#ifdef ST7789_MOCK_BUS
+
+STATIC void mock_begin(st7789_ST7789_obj_t *self) {
+}
+
+STATIC void mock_end(st7789_ST7789_obj_t *self) {
+}
+
+STATIC void mock_command(st7789_ST7789_obj_t *self, uint8_t cmd) {
+    mp_obj_list_append(self->mock_log, MP_OBJ_NEW_SMALL_INT(cmd));
+}
+
+STATIC void mock_data(st7789_ST7789_obj_t *self, const uint8_t *buf, int len) {
+    mp_obj_list_append(self->mock_log, mp_obj_new_bytes(buf, len));
+}
+
+STATIC void mock_fill(st7789_ST7789_obj_t *self, uint16_t color, int length) {
+    mp_obj_t run[2] = { MP_OBJ_NEW_SMALL_INT(color), mp_obj_new_int(length) };
+    mp_obj_list_append(self->mock_log, mp_obj_new_tuple(2, run));
+}
+
+STATIC const st7789_bus_t mock_bus = {
+    .begin = mock_begin,
+    .end = mock_end,
+    .command = mock_command,
+    .data = mock_data,
+    .fill = mock_fill,
+};
+
+#endif
 
 
 // just a definition
@@ -87,17 +308,23 @@ STATIC void st7789_ST7789_print( const mp_print_t *print,
 
 /* methods start */
 
+STATIC void write_data(st7789_ST7789_obj_t *self, const uint8_t *buf, int len) {
+    self->bus->data(self, buf, len);
+}
+
+STATIC void fill_color_buffer(st7789_ST7789_obj_t *self, uint16_t color, int length) {
+    self->bus->fill(self, color, length);
+}
+
 STATIC void write_cmd(st7789_ST7789_obj_t *self, uint8_t cmd, const uint8_t *data, int len) {
-    CS_LOW()
+    BUS_BEGIN();
     if (cmd) {
-        DC_LOW();
-        write_spi(self->spi_obj, &cmd, 1);
+        self->bus->command(self, cmd);
     }
     if (len > 0) {
-        DC_HIGH();
-        write_spi(self->spi_obj, data, len);
+        write_data(self, data, len);
     }
-    CS_HIGH()
+    BUS_END();
 }
 
 STATIC void set_window(st7789_ST7789_obj_t *self, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
@@ -109,61 +336,38 @@ STATIC void set_window(st7789_ST7789_obj_t *self, uint8_t x0, uint8_t y0, uint8_
     }
     uint8_t bufx[4] = {(x0+self->xstart) >> 8, (x0+self->xstart) & 0xFF, (x1+self->xstart) >> 8, (x1+self->xstart) & 0xFF};
     uint8_t bufy[4] = {(y0+self->ystart) >> 8, (y0+self->ystart) & 0xFF, (y1+self->ystart) >> 8, (y1+self->ystart) & 0xFF};
-    write_cmd(self, ST7789_CASET, bufx, 4);
-    write_cmd(self, ST7789_RASET, bufy, 4);
-    write_cmd(self, ST7789_RAMWR, NULL, 0);
-}
-
-STATIC void fill_color_buffer(mp_obj_base_t* spi_obj, uint16_t color, int length) {
-    uint8_t hi = color >> 8, lo = color;
-    const int buffer_pixel_size = 128;
-    int chunks = length / buffer_pixel_size;
-    int rest = length % buffer_pixel_size;
-
-    uint8_t buffer[buffer_pixel_size * 2]; // 128 pixels
-    // fill buffer with color data
-    for (int i = 0; i < length && i < buffer_pixel_size; i++) {
-        buffer[i*2] = hi;
-        buffer[i*2 + 1] = lo;
-    }
-
-    if (chunks) {
-        for (int j = 0; j < chunks; j ++) {
-            write_spi(spi_obj, buffer, buffer_pixel_size*2);
-        }
-    }
-    if (rest) {
-        write_spi(spi_obj, buffer, rest*2);
-    }
+    BUS_BEGIN();
+    self->bus->command(self, ST7789_CASET);
+    write_data(self, bufx, 4);
+    self->bus->command(self, ST7789_RASET);
+    write_data(self, bufy, 4);
+    self->bus->command(self, ST7789_RAMWR);
+    BUS_END();
 }
 
 
 STATIC void draw_pixel(st7789_ST7789_obj_t *self, uint8_t x, uint8_t y, uint16_t color) {
-    uint8_t hi = color >> 8, lo = color;
+    uint8_t buf[2] = {color >> 8, color};
     set_window(self, x, y, x, y);
-    DC_HIGH();
-    CS_LOW();
-    write_spi(self->spi_obj, &hi, 1);
-    write_spi(self->spi_obj, &lo, 1);
-    CS_HIGH();
+    BUS_BEGIN();
+    write_data(self, buf, 2);
+    BUS_END();
 }
 
 
 STATIC void fast_hline(st7789_ST7789_obj_t *self, uint8_t x, uint8_t y, uint16_t w, uint16_t color) {
     set_window(self, x, y, x + w - 1, y);
-    DC_HIGH();
-    CS_LOW();
-    fill_color_buffer(self->spi_obj, color, w);
-    CS_HIGH();
+    BUS_BEGIN();
+    fill_color_buffer(self, color, w);
+    BUS_END();
 }
 
 
 STATIC void fast_vline(st7789_ST7789_obj_t *self, uint8_t x, uint8_t y, uint16_t w, uint16_t color) {
     set_window(self, x, y, x, y + w - 1);
-    DC_HIGH();
-    CS_LOW();
-    fill_color_buffer(self->spi_obj, color, w);
-    CS_HIGH();
+    BUS_BEGIN();
+    fill_color_buffer(self, color, w);
+    BUS_END();
 }
 
 
@@ -255,25 +459,204 @@ STATIC mp_obj_t st7789_ST7789_fill_rect(size_t n_args, const mp_obj_t *args) {
     mp_int_t color = mp_obj_get_int(args[5]);
 
     set_window(self, x, y, x + w - 1, y + h - 1);
-    DC_HIGH();
-    CS_LOW();
-    fill_color_buffer(self->spi_obj, color, w * h);
-    CS_HIGH();
+    BUS_BEGIN();
+    fill_color_buffer(self, color, w * h);
+    BUS_END();
 
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(st7789_ST7789_fill_rect_obj, 6, 6, st7789_ST7789_fill_rect);
 
 
+// rgb565 channels in 16.16 fixed point, stepped linearly between two colors
+typedef struct _gradient_t {
+    int32_t r, g, b;
+    int32_t dr, dg, db;
+} gradient_t;
+
+STATIC void gradient_init(gradient_t *gr, uint16_t c0, uint16_t c1, int steps) {
+    int div = steps > 1 ? steps - 1 : 1;
+    // start at half a step to round instead of truncate
+    gr->r = ((c0 >> 11) & 0x1F) * 65536 + 0x8000;
+    gr->g = ((c0 >> 5) & 0x3F) * 65536 + 0x8000;
+    gr->b = (c0 & 0x1F) * 65536 + 0x8000;
+    gr->dr = (((c1 >> 11) & 0x1F) - ((c0 >> 11) & 0x1F)) * 65536 / div;
+    gr->dg = (((c1 >> 5) & 0x3F) - ((c0 >> 5) & 0x3F)) * 65536 / div;
+    gr->db = ((c1 & 0x1F) - (c0 & 0x1F)) * 65536 / div;
+}
+
+STATIC uint16_t gradient_next(gradient_t *gr) {
+    uint16_t color = ((gr->r >> 16) << 11) | ((gr->g >> 16) << 5) | (gr->b >> 16);
+    gr->r += gr->dr;
+    gr->g += gr->dg;
+    gr->b += gr->db;
+    return color;
+}
+
+
+STATIC mp_obj_t st7789_ST7789_fill_gradient(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_x, ARG_y, ARG_width, ARG_height, ARG_color0, ARG_color1, ARG_direction };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_x, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
+        { MP_QSTR_y, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
+        { MP_QSTR_width, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
+        { MP_QSTR_height, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
+        { MP_QSTR_color0, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
+        { MP_QSTR_color1, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
+        { MP_QSTR_direction, MP_ARG_INT, {.u_int = GRADIENT_HORIZONTAL} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    st7789_ST7789_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_int_t x = args[ARG_x].u_int;
+    mp_int_t y = args[ARG_y].u_int;
+    mp_int_t w = args[ARG_width].u_int;
+    mp_int_t h = args[ARG_height].u_int;
+    uint16_t c0 = args[ARG_color0].u_int;
+    uint16_t c1 = args[ARG_color1].u_int;
+    mp_int_t direction = args[ARG_direction].u_int;
+
+    if (direction != GRADIENT_HORIZONTAL && direction != GRADIENT_VERTICAL) {
+        mp_raise_ValueError(MP_ERROR_TEXT("direction must be HORIZONTAL or VERTICAL"));
+    }
+    if (w <= 0 || h <= 0) {
+        return mp_const_none;
+    }
+
+    gradient_t gr;
+    set_window(self, x, y, x + w - 1, y + h - 1);
+    BUS_BEGIN();
+    if (direction == GRADIENT_VERTICAL) {
+        // each row is a single color, neighbouring rows of the same color
+        // are sent as one run
+        gradient_init(&gr, c0, c1, h);
+        uint16_t color = gradient_next(&gr);
+        int rows = 1;
+        for (int j = 1; j < h; j++) {
+            uint16_t next = gradient_next(&gr);
+            if (next != color) {
+                fill_color_buffer(self, color, w * rows);
+                color = next;
+                rows = 0;
+            }
+            rows++;
+        }
+        fill_color_buffer(self, color, w * rows);
+    } else {
+        // every row is the same; a row that fits the chunk buffer is
+        // rendered once, wider rows are rendered chunk by chunk
+        uint8_t buffer[256];
+        const int buffer_pixel_size = sizeof(buffer) / 2;
+        bool rerender = w > buffer_pixel_size;
+        for (int j = 0; j < h; j++) {
+            if (j == 0 || rerender) {
+                gradient_init(&gr, c0, c1, w);
+            }
+            for (int i = 0; i < w; i += buffer_pixel_size) {
+                int len = MIN(w - i, buffer_pixel_size);
+                if (j == 0 || rerender) {
+                    for (int k = 0; k < len; k++) {
+                        uint16_t color = gradient_next(&gr);
+                        buffer[k * 2] = color >> 8;
+                        buffer[k * 2 + 1] = color;
+                    }
+                }
+                write_data(self, buffer, len * 2);
+            }
+        }
+    }
+    BUS_END();
+
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(st7789_ST7789_fill_gradient_obj, 1, st7789_ST7789_fill_gradient);
+
+
+// alpha is 0..256
+STATIC uint16_t blend565(uint16_t fg, uint16_t bg, int alpha) {
+    int r = (((fg >> 11) & 0x1F) * alpha + ((bg >> 11) & 0x1F) * (256 - alpha)) >> 8;
+    int g = (((fg >> 5) & 0x3F) * alpha + ((bg >> 5) & 0x3F) * (256 - alpha)) >> 8;
+    int b = ((fg & 0x1F) * alpha + (bg & 0x1F) * (256 - alpha)) >> 8;
+    return (r << 11) | (g << 5) | b;
+}
+
+
+STATIC mp_obj_t st7789_ST7789_fill_rect_alpha(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_x, ARG_y, ARG_width, ARG_height, ARG_color, ARG_alpha, ARG_under };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_x, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
+        { MP_QSTR_y, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
+        { MP_QSTR_width, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
+        { MP_QSTR_height, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
+        { MP_QSTR_color, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
+        { MP_QSTR_alpha, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
+        { MP_QSTR_under, MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    st7789_ST7789_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_int_t x = args[ARG_x].u_int;
+    mp_int_t y = args[ARG_y].u_int;
+    mp_int_t w = args[ARG_width].u_int;
+    mp_int_t h = args[ARG_height].u_int;
+    uint16_t color = args[ARG_color].u_int;
+    mp_int_t alpha = MAX(0, MIN(args[ARG_alpha].u_int, 255));
+    // scale 0..255 to 0..256, so that 255 is fully opaque
+    alpha += alpha >> 7;
+
+    if (w <= 0 || h <= 0) {
+        return mp_const_none;
+    }
+
+    if (args[ARG_under].u_obj == MP_OBJ_NULL || args[ARG_under].u_obj == mp_const_none) {
+        // nothing to read back from the display, blend over black
+        set_window(self, x, y, x + w - 1, y + h - 1);
+        BUS_BEGIN();
+        fill_color_buffer(self, blend565(color, BLACK, alpha), w * h);
+        BUS_END();
+        return mp_const_none;
+    }
+
+    mp_buffer_info_t under_info;
+    mp_get_buffer_raise(args[ARG_under].u_obj, &under_info, MP_BUFFER_READ);
+    if (under_info.len < (size_t)(w * h * 2)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("under buffer is too small"));
+    }
+    const uint8_t *under = under_info.buf;
+
+    set_window(self, x, y, x + w - 1, y + h - 1);
+    BUS_BEGIN();
+    uint8_t buffer[256];
+    int len = 0;
+    for (int i = 0; i < w * h; i++) {
+        uint16_t blended = blend565(color, (under[i * 2] << 8) | under[i * 2 + 1], alpha);
+        buffer[len++] = blended >> 8;
+        buffer[len++] = blended;
+        if (len == sizeof(buffer)) {
+            write_data(self, buffer, len);
+            len = 0;
+        }
+    }
+    if (len) {
+        write_data(self, buffer, len);
+    }
+    BUS_END();
+
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(st7789_ST7789_fill_rect_alpha_obj, 1, st7789_ST7789_fill_rect_alpha);
+
+
 STATIC mp_obj_t st7789_ST7789_fill(mp_obj_t self_in, mp_obj_t _color) {
     st7789_ST7789_obj_t *self = MP_OBJ_TO_PTR(self_in);
     mp_int_t color = mp_obj_get_int(_color);
 
     set_window(self, 0, 0, self->width - 1, self->height - 1);
-    DC_HIGH();
-    CS_LOW();
-    fill_color_buffer(self->spi_obj, color, self->width * self->height);
-    CS_HIGH();
+    BUS_BEGIN();
+    fill_color_buffer(self, color, self->width * self->height);
+    BUS_END();
 
     return mp_const_none;
 }
@@ -360,8 +743,7 @@ STATIC mp_obj_t st7789_ST7789_blit_buffer(size_t n_args, const mp_obj_t *args) {
     mp_int_t h = mp_obj_get_int(args[5]);
 
     set_window(self, x, y, x + w - 1, y + h - 1);
-    DC_HIGH();
-    CS_LOW();
+    BUS_BEGIN();
 
     const int buf_size = 256;
     int limit = MIN(buf_info.len, w * h * 2);
@@ -369,18 +751,276 @@ STATIC mp_obj_t st7789_ST7789_blit_buffer(size_t n_args, const mp_obj_t *args) {
     int rest = limit % buf_size;
     int i = 0;
     for (; i < chunks; i ++) {
-        write_spi(self->spi_obj, (const uint8_t*)buf_info.buf + i*buf_size, buf_size);
+        write_data(self, (const uint8_t*)buf_info.buf + i*buf_size, buf_size);
     }
     if (rest) {
-        write_spi(self->spi_obj, (const uint8_t*)buf_info.buf + i*buf_size, rest);
+        write_data(self, (const uint8_t*)buf_info.buf + i*buf_size, rest);
     }
-    CS_HIGH();
+    BUS_END();
 
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(st7789_ST7789_blit_buffer_obj, 6, 6, st7789_ST7789_blit_buffer);
 
 
+STATIC const uint16_t *get_int16_buffer(mp_obj_t obj, size_t *count) {
+    mp_buffer_info_t buf_info;
+    mp_get_buffer_raise(obj, &buf_info, MP_BUFFER_READ);
+    if (buf_info.typecode != 'h' && buf_info.typecode != 'H') {
+        mp_raise_TypeError(MP_ERROR_TEXT("expected array('h') or array('H')"));
+    }
+    *count = buf_info.len / 2;
+    return (const uint16_t*)buf_info.buf;
+}
+
+
+STATIC mp_obj_t st7789_ST7789_pixels(mp_obj_t self_in, mp_obj_t coords_in, mp_obj_t colors_in) {
+    st7789_ST7789_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    size_t n;
+    const uint16_t *coords = get_int16_buffer(coords_in, &n);
+    n /= 2;
+
+    // either one color for all points or a color per point
+    const uint16_t *colors = NULL;
+    uint16_t color = 0;
+    if (mp_obj_is_int(colors_in)) {
+        color = mp_obj_get_int(colors_in);
+    } else {
+        size_t n_colors;
+        colors = get_int16_buffer(colors_in, &n_colors);
+        if (n_colors < n) {
+            mp_raise_ValueError(MP_ERROR_TEXT("not enough colors"));
+        }
+    }
+    if (n > 0xFFFF) {
+        mp_raise_ValueError(MP_ERROR_TEXT("too many points"));
+    }
+
+    #define PX(i) ((int16_t)coords[(i) * 2])
+    #define PY(i) ((int16_t)coords[(i) * 2 + 1])
+    #define IN_BOUNDS(i) (PX(i) >= 0 && PX(i) < self->width && PY(i) >= 0 && PY(i) < self->height)
+
+    // stable LSD radix sort of the points by (y, x): a counting pass on x,
+    // then one on y. Points outside the display are dropped in the first
+    // pass. rows[y] ends up pointing past the last point of row y
+    size_t buckets = MAX(self->width, self->height) + 1;
+    size_t alloc_len = buckets + 2 * n;
+    uint16_t *rows = m_new(uint16_t, alloc_len);
+    uint16_t *by_x = rows + buckets;
+    uint16_t *order = by_x + n;
+    size_t count = 0;
+
+    memset(rows, 0, (self->width + 1) * sizeof(uint16_t));
+    for (size_t i = 0; i < n; i++) {
+        if (IN_BOUNDS(i)) {
+            rows[PX(i) + 1]++;
+            count++;
+        }
+    }
+    for (int x = 0; x < self->width; x++) {
+        rows[x + 1] += rows[x];
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (IN_BOUNDS(i)) {
+            by_x[rows[PX(i)]++] = i;
+        }
+    }
+
+    memset(rows, 0, (self->height + 1) * sizeof(uint16_t));
+    for (size_t i = 0; i < count; i++) {
+        rows[PY(by_x[i]) + 1]++;
+    }
+    for (int y = 0; y < self->height; y++) {
+        rows[y + 1] += rows[y];
+    }
+    for (size_t i = 0; i < count; i++) {
+        order[rows[PY(by_x[i])]++] = by_x[i];
+    }
+
+    uint8_t buffer[256];
+    for (int y = 0; y < self->height; y++) {
+        size_t start = y ? rows[y - 1] : 0, end = rows[y];
+
+        // send every run of adjacent points under a single window
+        size_t i = start;
+        while (i < end) {
+            int16_t x0 = PX(order[i]), x1 = x0;
+            size_t j = i + 1;
+            for (; j < end && PX(order[j]) <= x1 + 1; j++) {
+                x1 = PX(order[j]);
+            }
+
+            set_window(self, x0, y, x1, y);
+            BUS_BEGIN();
+            if (!colors) {
+                fill_color_buffer(self, color, x1 - x0 + 1);
+            } else {
+                int len = 0;
+                for (size_t k = i; k < j; k++) {
+                    // of the points sharing a pixel, the last one wins
+                    if (k + 1 < j && PX(order[k + 1]) == PX(order[k])) {
+                        continue;
+                    }
+                    uint16_t c = colors[order[k]];
+                    buffer[len++] = c >> 8;
+                    buffer[len++] = c;
+                    if (len == sizeof(buffer)) {
+                        write_data(self, buffer, len);
+                        len = 0;
+                    }
+                }
+                if (len) {
+                    write_data(self, buffer, len);
+                }
+            }
+            BUS_END();
+            i = j;
+        }
+    }
+
+    #undef PX
+    #undef PY
+    #undef IN_BOUNDS
+
+    m_del(uint16_t, rows, alloc_len);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(st7789_ST7789_pixels_obj, st7789_ST7789_pixels);
+
+
+STATIC mp_obj_t st7789_ST7789_plot_series(size_t n_args, const mp_obj_t *args) {
+    st7789_ST7789_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    size_t n;
+    const uint16_t *ys = get_int16_buffer(args[1], &n);
+    mp_int_t x0 = mp_obj_get_int(args[2]);
+    mp_int_t color = mp_obj_get_int(args[3]);
+
+    // every column is a vertical span from its own value up to
+    // (but not including) the value of the previous column
+    for (size_t i = 0; i < n; i++) {
+        mp_int_t x = x0 + i;
+        if (x < 0) {
+            continue;
+        }
+        if (x >= self->width) {
+            break;
+        }
+        int lo = (int16_t)ys[i], hi = lo;
+        int prev = i ? (int16_t)ys[i - 1] : lo;
+        if (prev > hi + 1) {
+            hi = prev - 1;
+        } else if (prev < lo - 1) {
+            lo = prev + 1;
+        }
+        lo = MAX(lo, 0);
+        hi = MIN(hi, self->height - 1);
+        if (lo <= hi) {
+            fast_vline(self, x, lo, hi - lo + 1, color);
+        }
+    }
+
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(st7789_ST7789_plot_series_obj, 4, 4, st7789_ST7789_plot_series);
+
+
+// returns false on a clean end of stream, raises if it ends mid-read
+STATIC bool read_stream(mp_obj_t stream, uint8_t *buf, mp_uint_t len) {
+    int errcode = 0;
+    mp_uint_t out = mp_stream_rw(stream, buf, len, &errcode, MP_STREAM_RW_READ);
+    if (errcode != 0) {
+        mp_raise_OSError(errcode);
+    }
+    if (out != 0 && out != len) {
+        mp_raise_ValueError(MP_ERROR_TEXT("truncated animation"));
+    }
+    return out == len;
+}
+
+
+STATIC void read_stream_raise(mp_obj_t stream, uint8_t *buf, mp_uint_t len) {
+    if (!read_stream(stream, buf, len)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("truncated animation"));
+    }
+}
+
+
+STATIC void play_span(st7789_ST7789_obj_t *self, mp_obj_t stream, const uint8_t *span) {
+    uint8_t x = span[0], y = span[1], w = span[2], h = span[3], flags = span[4];
+    if (!w || !h || x + w > self->width || y + h > self->height) {
+        mp_raise_ValueError(MP_ERROR_TEXT("span out of bounds"));
+    }
+
+    set_window(self, x, y, x + w - 1, y + h - 1);
+
+    // the stream may be a file on an SD card sharing the bus, so CS is
+    // only held for each write; RAMWR carries on across transactions
+    int pixels = w * h;
+    if (flags & ANIM_SPAN_RLE) {
+        // (count, color hi, color lo) runs until the span is covered
+        uint8_t run[3];
+        while (pixels > 0) {
+            read_stream_raise(stream, run, 3);
+            int count = MIN(run[0], pixels);
+            BUS_BEGIN();
+            fill_color_buffer(self, (run[1] << 8) | run[2], count);
+            BUS_END();
+            pixels -= count;
+        }
+    } else {
+        uint8_t buffer[256];
+        int rest = pixels * 2;
+        while (rest > 0) {
+            int chunk = MIN(rest, (int)sizeof(buffer));
+            read_stream_raise(stream, buffer, chunk);
+            BUS_BEGIN();
+            write_data(self, buffer, chunk);
+            BUS_END();
+            rest -= chunk;
+        }
+    }
+}
+
+
+STATIC mp_obj_t st7789_ST7789_play(size_t n_args, const mp_obj_t *args) {
+    st7789_ST7789_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_obj_t stream = args[1];
+    mp_int_t fps = mp_obj_get_int(args[2]);
+
+    mp_get_stream_raise(stream, MP_STREAM_OP_READ);
+
+    mp_uint_t period = fps > 0 ? 1000 / fps : 0;
+    mp_uint_t next_frame = mp_hal_ticks_ms();
+    mp_int_t frames = 0;
+    uint8_t header[5];
+
+    // every frame is a little-endian span count followed by the spans;
+    // playback stops at the end of the stream
+    while (read_stream(stream, header, 2)) {
+        int spans = header[0] | (header[1] << 8);
+        for (int i = 0; i < spans; i++) {
+            read_stream_raise(stream, header, 5);
+            play_span(self, stream, header);
+        }
+        frames++;
+
+        if (period) {
+            next_frame += period;
+            mp_int_t wait = (mp_int_t)(next_frame - mp_hal_ticks_ms());
+            if (wait > 0) {
+                mp_hal_delay_ms(wait);
+            } else {
+                // running late, do not try to catch up
+                next_frame = mp_hal_ticks_ms();
+            }
+        }
+    }
+
+    return mp_obj_new_int(frames);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(st7789_ST7789_play_obj, 3, 3, st7789_ST7789_play);
+
+
 STATIC mp_obj_t st7789_ST7789_init(mp_obj_t self_in) {
     st7789_ST7789_obj_t *self = MP_OBJ_TO_PTR(self_in);
     st7789_ST7789_hard_reset(self_in);
@@ -491,10 +1131,15 @@ STATIC const mp_rom_map_elem_t st7789_ST7789_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_on), MP_ROM_PTR(&st7789_ST7789_on_obj) },
     { MP_ROM_QSTR(MP_QSTR_off), MP_ROM_PTR(&st7789_ST7789_off_obj) },
     { MP_ROM_QSTR(MP_QSTR_pixel), MP_ROM_PTR(&st7789_ST7789_pixel_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pixels), MP_ROM_PTR(&st7789_ST7789_pixels_obj) },
+    { MP_ROM_QSTR(MP_QSTR_plot_series), MP_ROM_PTR(&st7789_ST7789_plot_series_obj) },
     { MP_ROM_QSTR(MP_QSTR_line), MP_ROM_PTR(&st7789_ST7789_line_obj) },
     { MP_ROM_QSTR(MP_QSTR_blit_buffer), MP_ROM_PTR(&st7789_ST7789_blit_buffer_obj) },
+    { MP_ROM_QSTR(MP_QSTR_play), MP_ROM_PTR(&st7789_ST7789_play_obj) },
     { MP_ROM_QSTR(MP_QSTR_fill_rect), MP_ROM_PTR(&st7789_ST7789_fill_rect_obj) },
     { MP_ROM_QSTR(MP_QSTR_fill), MP_ROM_PTR(&st7789_ST7789_fill_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fill_gradient), MP_ROM_PTR(&st7789_ST7789_fill_gradient_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fill_rect_alpha), MP_ROM_PTR(&st7789_ST7789_fill_rect_alpha_obj) },
     { MP_ROM_QSTR(MP_QSTR_hline), MP_ROM_PTR(&st7789_ST7789_hline_obj) },
     { MP_ROM_QSTR(MP_QSTR_vline), MP_ROM_PTR(&st7789_ST7789_vline_obj) },
     { MP_ROM_QSTR(MP_QSTR_rect), MP_ROM_PTR(&st7789_ST7789_rect_obj) },
@@ -518,7 +1163,7 @@ mp_obj_t st7789_ST7789_make_new(const mp_obj_type_t *type,
                                 const mp_obj_t *all_args ) {
     enum {
         ARG_spi, ARG_width, ARG_height, ARG_reset, ARG_dc, ARG_cs,
-        ARG_backlight, ARG_xstart, ARG_ystart
+        ARG_backlight, ARG_xstart, ARG_ystart, ARG_data, ARG_wr
     };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_spi, MP_ARG_OBJ | MP_ARG_REQUIRED, {.u_obj = MP_OBJ_NULL} },
@@ -530,6 +1175,8 @@ mp_obj_t st7789_ST7789_make_new(const mp_obj_type_t *type,
         { MP_QSTR_backlight, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
         { MP_QSTR_xstart, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = -1} },
         { MP_QSTR_ystart, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = -1} },
+        { MP_QSTR_data, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_wr, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -538,9 +1185,43 @@ mp_obj_t st7789_ST7789_make_new(const mp_obj_type_t *type,
     st7789_ST7789_obj_t *self = m_new_obj(st7789_ST7789_obj_t);
     self->base.type = &st7789_ST7789_type;
 
+    // select the bus transport
+    mp_obj_t bus_obj = args[ARG_spi].u_obj;
+#ifdef ST7789_MOCK_BUS
+    if (!mp_obj_is_type(bus_obj, &mp_type_list)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("mock bus expects a list"));
+    }
+    self->spi_obj = NULL;
+    self->mock_log = bus_obj;
+    self->bus = &mock_bus;
+#else
+    if (args[ARG_data].u_obj != MP_OBJ_NULL) {
+#ifdef ST7789_PARALLEL_BUS
+        size_t data_len;
+        mp_obj_t *data_pins;
+        mp_obj_get_array(args[ARG_data].u_obj, &data_len, &data_pins);
+        if (data_len != 8 || args[ARG_wr].u_obj == MP_OBJ_NULL) {
+            mp_raise_ValueError(MP_ERROR_TEXT("parallel bus requires 8 data pins and wr pin"));
+        }
+        for (int i = 0; i < 8; i++) {
+            self->data_pins[i] = mp_hal_get_pin_obj(data_pins[i]);
+        }
+        self->wr = mp_hal_get_pin_obj(args[ARG_wr].u_obj);
+        mp_hal_pin_write(self->wr, 1);
+        self->data_level = -1;
+        self->spi_obj = NULL;
+        self->bus = &parallel_bus;
+#else
+        mp_raise_ValueError(MP_ERROR_TEXT("parallel bus is not enabled"));
+#endif
+    } else {
+        self->spi_obj = (mp_obj_base_t*)MP_OBJ_TO_PTR(bus_obj);
+        self->bus = &spi_bus;
+    }
+    self->dc_level = -1;
+#endif
+
     // set parameters
-    mp_obj_base_t *spi_obj = (mp_obj_base_t*)MP_OBJ_TO_PTR(args[ARG_spi].u_obj);
-    self->spi_obj = spi_obj;
     self->width = args[ARG_width].u_int;
     self->height = args[ARG_height].u_int;
 
@@ -557,6 +1238,7 @@ mp_obj_t st7789_ST7789_make_new(const mp_obj_type_t *type,
         mp_raise_ValueError(MP_ERROR_TEXT("Unsupported display. Only 240x240 and 135x240 are supported without xstart and ystart provided"));
     }
 
+#if ST7789_USE_PINS
     if (args[ARG_reset].u_obj == MP_OBJ_NULL
         || args[ARG_dc].u_obj == MP_OBJ_NULL) {
         mp_raise_ValueError(MP_ERROR_TEXT("must specify all of reset/dc pins"));
@@ -571,6 +1253,7 @@ mp_obj_t st7789_ST7789_make_new(const mp_obj_type_t *type,
     if (args[ARG_backlight].u_obj != MP_OBJ_NULL) {
         self->backlight = mp_hal_get_pin_obj(args[ARG_backlight].u_obj);
     }
+#endif
 
     return MP_OBJ_FROM_PTR(self);
 }
@@ -654,6 +1337,8 @@ STATIC const mp_map_elem_t st7789_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_MAGENTA), MP_ROM_INT(MAGENTA) },
     { MP_ROM_QSTR(MP_QSTR_YELLOW), MP_ROM_INT(YELLOW) },
     { MP_ROM_QSTR(MP_QSTR_WHITE), MP_ROM_INT(WHITE) },
+    { MP_ROM_QSTR(MP_QSTR_HORIZONTAL), MP_ROM_INT(GRADIENT_HORIZONTAL) },
+    { MP_ROM_QSTR(MP_QSTR_VERTICAL), MP_ROM_INT(GRADIENT_VERTICAL) },
 };
 
 STATIC MP_DEFINE_CONST_DICT (mp_module_st7789_globals, st7789_module_globals_table );
@@ -56,6 +56,13 @@ extern "C" {
 #define ST7789_RDID3   0xDC
 #define ST7789_RDID4   0xDD
 
+// animation span flags
+#define ANIM_SPAN_RLE 0x01
+
+// gradient directions
+#define GRADIENT_HORIZONTAL 0
+#define GRADIENT_VERTICAL   1
+
 // Color definitions
 #define	BLACK   0x0000
 #define	BLUE    0x001F
@@ -0,0 +1,63 @@
+# Helpers for checking the bus log recorded by the mock transport.
+#
+# Build the unix port with the mock transport and run the tests with it:
+#
+#   cd micropython/ports/unix
+#   make USER_C_MODULES=../../../st7789_mpy/ CFLAGS_EXTRA=-DST7789_MOCK_BUS=1
+#   ./micropython ../../../st7789_mpy/tests/test_mock_bus.py
+
+CASET = 0x2A
+RASET = 0x2B
+RAMWR = 0x2C
+
+
+def window(x0, y0, x1, y1, xstart=0, ystart=0):
+    x0 += xstart
+    x1 += xstart
+    y0 += ystart
+    y1 += ystart
+    return [CASET, bytes([x0 >> 8, x0 & 0xFF, x1 >> 8, x1 & 0xFF]),
+            RASET, bytes([y0 >> 8, y0 & 0xFF, y1 >> 8, y1 & 0xFF]),
+            RAMWR]
+
+
+def pixels(*colors):
+    out = b''
+    for c in colors:
+        out += bytes([c >> 8, c & 0xFF])
+    return out
+
+
+def normalize(log):
+    # data writes may be split into chunks, join the consecutive ones
+    out = []
+    for entry in log:
+        if isinstance(entry, bytes) and out and isinstance(out[-1], bytes):
+            out[-1] += entry
+        else:
+            out.append(entry)
+    return out
+
+
+def fail(name, *details):
+    print('FAIL', name)
+    for d in details:
+        print('  ', d)
+    raise SystemExit(1)
+
+
+def check(name, log, expected):
+    result = normalize(log)
+    if result != expected:
+        fail(name, 'expected %r' % (expected,), 'got      %r' % (result,))
+    print('ok', name)
+    log[:] = []
+
+
+def check_raises(name, exc, func, *args, **kwargs):
+    try:
+        func(*args, **kwargs)
+    except exc:
+        print('ok', name)
+        return
+    fail(name, 'expected %s' % exc.__name__)
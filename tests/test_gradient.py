@@ -0,0 +1,37 @@
+# Checks the bus traffic of fill_gradient() and fill_rect_alpha() with the
+# recording mock, see mockbus.py for how to build and run.
+
+import st7789
+from mockbus import window, pixels, check, check_raises
+
+log = []
+display = st7789.ST7789(log, 240, 240)
+
+display.fill_gradient(0, 0, 2, 4, st7789.BLACK, st7789.RED, direction=st7789.VERTICAL)
+check('fill_gradient vertical', log,
+      window(0, 0, 1, 3) + [(0x0000, 2), (0x5000, 2), (0xA800, 2), (0xF800, 2)])
+
+display.fill_gradient(0, 0, 4, 2, st7789.BLACK, st7789.RED, st7789.HORIZONTAL)
+check('fill_gradient horizontal', log,
+      window(0, 0, 3, 1) + [pixels(0x0000, 0x5000, 0xA800, 0xF800) * 2])
+
+display.fill_gradient(x=0, y=0, width=4, height=1,
+                      color0=st7789.BLACK, color1=st7789.RED)
+check('fill_gradient keywords', log,
+      window(0, 0, 3, 0) + [pixels(0x0000, 0x5000, 0xA800, 0xF800)])
+
+check_raises('fill_gradient direction', ValueError, display.fill_gradient,
+             0, 0, 4, 2, st7789.BLACK, st7789.RED, 2)
+check_raises('fill_gradient missing color', TypeError, display.fill_gradient,
+             0, 0, 4, 2, st7789.BLACK)
+
+display.fill_rect_alpha(0, 0, width=1, height=1, color=st7789.BLACK, alpha=128,
+                        under=pixels(st7789.WHITE))
+check('fill_rect_alpha', log, window(0, 0, 0, 0) + [pixels(0x7BEF)])
+
+# without a background the color is blended over black, a single fill
+display.fill_rect_alpha(1, 2, 2, 1, st7789.WHITE, 128)
+check('fill_rect_alpha over black', log, window(1, 2, 2, 2) + [(0x7BEF, 2)])
+
+check_raises('fill_rect_alpha missing alpha', TypeError, display.fill_rect_alpha,
+             0, 0, 1, 1, st7789.WHITE)
@@ -0,0 +1,34 @@
+# Checks the bus traffic of the basic drawing methods with the recording
+# mock, see mockbus.py for how to build and run.
+
+import st7789
+from mockbus import window, pixels, check, check_raises
+
+log = []
+display = st7789.ST7789(log, 240, 240)
+
+display.fill_rect(0, 0, 10, 10, st7789.RED)
+check('fill_rect', log, window(0, 0, 9, 9) + [(st7789.RED, 100)])
+
+display.fill(st7789.BLUE)
+check('fill', log, window(0, 0, 239, 239) + [(st7789.BLUE, 240 * 240)])
+
+display.hline(3, 4, 5, st7789.GREEN)
+check('hline', log, window(3, 4, 7, 4) + [(st7789.GREEN, 5)])
+
+display.vline(3, 4, 5, st7789.GREEN)
+check('vline', log, window(3, 4, 3, 8) + [(st7789.GREEN, 5)])
+
+display.pixel(1, 2, st7789.RED)
+check('pixel', log, window(1, 2, 1, 2) + [pixels(st7789.RED)])
+
+buf = pixels(1, 2, 3, 4)
+display.blit_buffer(buf, 10, 20, 2, 2)
+check('blit_buffer', log, window(10, 20, 11, 21) + [buf])
+
+# the 135x240 panel is addressed with an offset
+small = st7789.ST7789(log, 135, 240)
+small.fill_rect(0, 0, 1, 1, st7789.WHITE)
+check('offsets', log, window(0, 0, 0, 0, 52, 40) + [(st7789.WHITE, 1)])
+
+check_raises('mock requires a list', TypeError, st7789.ST7789, None, 240, 240)
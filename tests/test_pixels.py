@@ -0,0 +1,79 @@
+# Checks the bus traffic of pixels() and plot_series() with the recording
+# mock, see mockbus.py for how to build and run.
+
+from array import array
+import st7789
+from mockbus import window, pixels, check
+
+log = []
+display = st7789.ST7789(log, 240, 240)
+
+# rows are sent top to bottom, adjacent points share a window and
+# the last of the points on the same pixel wins
+coords = array('h', [5, 3, 3, 3, 4, 3, 9, 3, 1, 0, 4, 3, -1, 3, 240, 3])
+colors = array('H', [1, 2, 3, 4, 5, 6, 7, 8])
+display.pixels(coords, colors)
+check('pixels', log,
+      window(1, 0, 1, 0) + [pixels(5)]
+      + window(3, 3, 5, 3) + [pixels(2, 6, 1)]
+      + window(9, 3, 9, 3) + [pixels(4)])
+
+display.pixels(coords, st7789.GREEN)
+check('pixels single color', log,
+      window(1, 0, 1, 0) + [(st7789.GREEN, 1)]
+      + window(3, 3, 5, 3) + [(st7789.GREEN, 3)]
+      + window(9, 3, 9, 3) + [(st7789.GREEN, 1)])
+
+# a full row given right to left is a single run
+coords = array('h')
+colors = array('H')
+for x in range(239, -1, -1):
+    coords.append(x)
+    coords.append(7)
+    colors.append(x)
+display.pixels(coords, colors)
+check('pixels full row', log,
+      window(0, 7, 239, 7) + [pixels(*range(240))])
+
+
+def columns(color, *spans):
+    # one window per column, covering (x, top, bottom)
+    out = []
+    for x, top, bottom in spans:
+        out += window(x, top, x, bottom) + [(color, bottom - top + 1)]
+    return out
+
+
+# every column connects down to (or up to) the previous value
+display.plot_series(array('h', [10, 11, 14]), 5, st7789.RED)
+check('plot_series rising', log,
+      columns(st7789.RED, (5, 10, 10), (6, 11, 11), (7, 12, 14)))
+
+display.plot_series(array('h', [20, 15, 14]), 0, st7789.RED)
+check('plot_series falling', log,
+      columns(st7789.RED, (0, 20, 20), (1, 15, 19), (2, 14, 14)))
+
+display.plot_series(array('h', [30, 30, 30]), 0, st7789.RED)
+check('plot_series flat', log,
+      columns(st7789.RED, (0, 30, 30), (1, 30, 30), (2, 30, 30)))
+
+# the off-screen first value is still connected to
+display.plot_series(array('h', [1, 5, 9]), -1, st7789.RED)
+check('plot_series negative x0', log,
+      columns(st7789.RED, (0, 2, 5), (1, 6, 9)))
+
+display.plot_series(array('h', [235, 250, 238]), 100, st7789.RED)
+check('plot_series below the bottom', log,
+      columns(st7789.RED, (100, 235, 235), (101, 236, 239), (102, 238, 239)))
+
+display.plot_series(array('h', [300, 300]), 0, st7789.RED)
+display.plot_series(array('h', [-5, -5]), 0, st7789.RED)
+check('plot_series off-screen values', log, [])
+
+# a jump across the whole screen is drawn clipped
+display.plot_series(array('h', [300, -5]), 0, st7789.RED)
+check('plot_series crossing', log, columns(st7789.RED, (1, 0, 239)))
+
+display.plot_series(array('h', [0, 0, 0, 0]), 238, st7789.RED)
+check('plot_series right edge', log,
+      columns(st7789.RED, (238, 0, 0), (239, 0, 0)))
@@ -0,0 +1,39 @@
+# Checks the bus traffic of play() with the recording mock, see mockbus.py
+# for how to build and run. The animations are made with utils/anim_encode.py.
+
+import io
+import sys
+import st7789
+from mockbus import window, pixels, check, check_raises
+
+here = __file__.rsplit('/', 1)[0] if '/' in __file__ else '.'
+sys.path.append(here + '/../utils')
+import anim_encode
+
+log = []
+display = st7789.ST7789(log, 240, 240)
+
+# the first frame is stored completely as a single rle run, the second
+# only changes three pixels of a row, which are cheaper to store raw
+first = [0x1234] * 32
+second = list(first)
+second[8 + 2:8 + 5] = [1, 2, 3]
+data = anim_encode.encode([first, second], 8, 4)
+
+frames = display.play(io.BytesIO(data), 0)
+check('play', log,
+      window(0, 0, 7, 3) + [(0x1234, 32)]
+      + window(2, 1, 4, 1) + [pixels(1, 2, 3)])
+if frames != 2:
+    print('FAIL play frame count', frames)
+    raise SystemExit(1)
+
+check_raises('play partial span count', ValueError, display.play,
+             io.BytesIO(data + b'\x01'), 0)
+log[:] = []
+check_raises('play partial span header', ValueError, display.play,
+             io.BytesIO(b'\x01\x00\x00\x00'), 0)
+check_raises('play span out of bounds', ValueError, display.play,
+             io.BytesIO(b'\x01\x00' + bytes([236, 0, 8, 1, 1]) + b'\x01\x00\x00'), 0)
+check_raises('play missing pixels', ValueError, display.play,
+             io.BytesIO(b'\x01\x00' + bytes([0, 0, 2, 1, 0]) + b'\x00\x00'), 0)
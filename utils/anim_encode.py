@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""
+Encode a sequence of RGB565 frames into a delta animation for ST7789.play()
+
+Every frame is stored as a list of rectangular spans that differ from the
+previous frame. The first frame is stored completely.
+
+Stream format:
+
+    frame := span_count:u16le span*
+    span  := x:u8 y:u8 w:u8 h:u8 flags:u8 payload
+    payload (flags & 1 == 0) := w*h*2 bytes of big-endian rgb565 pixels
+    payload (flags & 1 == 1) := (count:u8 color_hi:u8 color_lo:u8)* runs
+
+Input frames are raw big-endian rgb565 files (the same layout as
+blit_buffer() expects) or, if Pillow is installed, any image format.
+
+Usage:
+
+    anim_encode.py -W 240 -H 240 -o boot.anim frame*.png
+"""
+
+import struct
+import sys
+
+SPAN_RLE = 0x01
+MAX_RUN = 255
+MAX_SIDE = 255
+
+
+def load_frame(path, width, height):
+    if path.endswith(('.raw', '.bin', '.rgb565')):
+        with open(path, 'rb') as f:
+            data = f.read()
+    else:
+        from PIL import Image
+        img = Image.open(path).convert('RGB').resize((width, height))
+        data = bytearray()
+        for r, g, b in img.getdata():
+            c = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+            data += struct.pack('>H', c)
+    if len(data) != width * height * 2:
+        raise ValueError('%s: expected %d bytes, got %d' % (
+            path, width * height * 2, len(data)))
+    return struct.unpack('>%dH' % (width * height), data)
+
+
+def row_spans(prev, cur, width, y, gap):
+    """Return (x, w) runs of changed pixels in a row, merging short gaps"""
+    spans = []
+    base = y * width
+    start = last = None
+    for x in range(width):
+        if prev is not None and prev[base + x] == cur[base + x]:
+            continue
+        if start is not None and x - last - 1 <= gap and x - start < MAX_SIDE:
+            last = x
+            continue
+        if start is not None:
+            spans.append((start, last - start + 1))
+        start = last = x
+    if start is not None:
+        spans.append((start, last - start + 1))
+    return spans
+
+
+def frame_rects(prev, cur, width, height, gap):
+    """Stack identical row spans of consecutive rows into rectangles"""
+    rects = []
+    open_rects = {}
+    for y in range(height):
+        still_open = {}
+        for x, w in row_spans(prev, cur, width, y, gap):
+            rect = open_rects.get((x, w))
+            if rect is not None and rect[3] < MAX_SIDE:
+                rect[3] += 1
+            else:
+                rect = [x, y, w, 1]
+                rects.append(rect)
+            still_open[(x, w)] = rect
+        open_rects = still_open
+    return rects
+
+
+def encode_rle(pixels):
+    out = bytearray()
+    i = 0
+    while i < len(pixels):
+        color = pixels[i]
+        count = 1
+        while (i + count < len(pixels) and count < MAX_RUN
+               and pixels[i + count] == color):
+            count += 1
+        out += struct.pack('>BH', count, color)
+        i += count
+    return out
+
+
+def encode_frame(prev, cur, width, height, gap=4, rle=True):
+    rects = frame_rects(prev, cur, width, height, gap)
+    out = bytearray(struct.pack('<H', len(rects)))
+    for x, y, w, h in rects:
+        pixels = [cur[(y + j) * width + x + i]
+                  for j in range(h) for i in range(w)]
+        raw = struct.pack('>%dH' % len(pixels), *pixels)
+        packed = encode_rle(pixels) if rle else None
+        if packed is not None and len(packed) < len(raw):
+            out += struct.pack('BBBBB', x, y, w, h, SPAN_RLE) + packed
+        else:
+            out += struct.pack('BBBBB', x, y, w, h, 0) + raw
+    return out
+
+
+def encode(frames, width, height, gap=4, rle=True):
+    out = bytearray()
+    prev = None
+    for cur in frames:
+        out += encode_frame(prev, cur, width, height, gap, rle)
+        prev = cur
+    return out
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[1])
+    parser.add_argument('-W', '--width', type=int, required=True)
+    parser.add_argument('-H', '--height', type=int, required=True)
+    parser.add_argument('-o', '--output', required=True)
+    parser.add_argument('-g', '--gap', type=int, default=4,
+                        help='merge changed pixels separated by up to GAP '
+                             'unchanged ones into a single span')
+    parser.add_argument('--no-rle', action='store_true',
+                        help='always store raw pixels')
+    parser.add_argument('frames', nargs='+')
+    args = parser.parse_args()
+
+    if not 0 < args.width <= MAX_SIDE or not 0 < args.height <= MAX_SIDE:
+        parser.error('width and height must be in range 1..%d' % MAX_SIDE)
+
+    frames = [load_frame(p, args.width, args.height) for p in args.frames]
+    data = encode(frames, args.width, args.height, args.gap, not args.no_rle)
+    with open(args.output, 'wb') as f:
+        f.write(data)
+
+    full = len(frames) * args.width * args.height * 2
+    print('%d frames, %d bytes (%.1f%% of raw)' % (
+        len(frames), len(data), 100.0 * len(data) / full), file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()